@@ -0,0 +1,349 @@
+#include "rebind.h"
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+using namespace rebind;
+
+// Pool allocation driven by a list of types. PoolSet keeps one free-list pool
+// per type in the list, carved from thread-local slabs. PoolAllocator is a
+// stateless standard allocator whose rebind routes each type it is asked for -
+// in particular, the node types of std::list, std::map and friends - to the
+// pool for that exact type if there is one, or otherwise to the smallest pool
+// whose type is large enough and sufficiently aligned. This choice is made at
+// compile time. Anything that fits no pool, and all array allocations, go to
+// ::operator new.
+//
+// Slabs are never returned to the system. Blocks freed on another thread join
+// that thread's free list, and a thread's free blocks are handed on to other
+// threads when it exits.
+
+constexpr std::size_t Max(std::size_t a, std::size_t b)
+{
+    return a < b ? b : a;
+}
+
+constexpr std::size_t AlignUp(std::size_t n, std::size_t alignment)
+{
+    return (n + alignment - 1) / alignment * alignment;
+}
+
+// Free-list pool for blocks that can hold a T. Set distinguishes pools for the
+// same type that belong to different PoolSets.
+template <typename Set, typename T>
+class Pool
+{
+    static_assert(alignof(T) <= alignof(std::max_align_t),
+                  "Over-aligned types are not supported");
+
+    struct Block
+    {
+        Block* next;
+    };
+
+    static constexpr std::size_t blockAlignment = Max(alignof(T),
+                                                      alignof(Block));
+    static constexpr std::size_t blockSize = AlignUp(Max(sizeof(T),
+                                                         sizeof(Block)),
+                                                     blockAlignment);
+    static constexpr std::size_t blocksPerSlab = Max(4096 / blockSize, 16);
+
+    // Free blocks left behind by threads that have exited
+    struct Orphans
+    {
+        std::mutex mutex;
+        Block* head = nullptr;
+    };
+
+    static Orphans& orphans()
+    {
+        static Orphans instance;
+        return instance;
+    }
+
+    struct ThreadCache
+    {
+        Block* head = nullptr;
+        unsigned char* slab = nullptr;
+        unsigned char* slabEnd = nullptr;
+
+        ~ThreadCache()
+        {
+            while (slab != slabEnd)
+            {
+                push(reinterpret_cast<Block*>(slab));
+                slab += blockSize;
+            }
+            if (head == nullptr)
+            {
+                return;
+            }
+            Block* tail = head;
+            while (tail->next != nullptr)
+            {
+                tail = tail->next;
+            }
+            Orphans& o = orphans();
+            std::lock_guard<std::mutex> lock(o.mutex);
+            tail->next = o.head;
+            o.head = head;
+        }
+
+        void push(Block* block)
+        {
+            block->next = head;
+            head = block;
+        }
+
+        void refill()
+        {
+            {
+                Orphans& o = orphans();
+                std::lock_guard<std::mutex> lock(o.mutex);
+                head = o.head;
+                o.head = nullptr;
+            }
+            if (head == nullptr)
+            {
+                slab = static_cast<unsigned char*>(
+                    ::operator new(blockSize * blocksPerSlab));
+                slabEnd = slab + blockSize * blocksPerSlab;
+            }
+        }
+    };
+
+    static ThreadCache& cache()
+    {
+        static thread_local ThreadCache instance;
+        return instance;
+    }
+
+public:
+    static void* allocate()
+    {
+        ThreadCache& c = cache();
+        if (c.head == nullptr && c.slab == c.slabEnd)
+        {
+            c.refill();
+        }
+        if (c.head != nullptr)
+        {
+            Block* block = c.head;
+            c.head = block->next;
+            return block;
+        }
+        void* block = c.slab;
+        c.slab += blockSize;
+        return block;
+    }
+
+    static void deallocate(void* p)
+    {
+        cache().push(static_cast<Block*>(p));
+    }
+};
+
+template <typename T1, typename T2>
+using SmallerThan = std::integral_constant<bool, (sizeof(T1) < sizeof(T2))>;
+
+template <typename Types>
+class PoolSet
+{
+    using BySize = Sort<Types, SmallerThan>;
+
+    // Choose the pool for U: its own if it has one, otherwise the smallest that
+    // fits, otherwise void
+    template <typename U>
+    struct Route
+    {
+        template <typename T>
+        using Fits = std::integral_constant<bool,
+                                            sizeof(U) <= sizeof(T)
+                                            && alignof(U) <= alignof(T)>;
+
+        // Accumulate operation that keeps the first pool to fit
+        template <typename Chosen, typename T>
+        using FirstFit = typename std::conditional<
+            std::is_void<Chosen>::value && Fits<T>::value, T, Chosen>::type;
+
+        using type = typename std::conditional<
+            Contains<Types, U>::value,
+            U,
+            Accumulate<BySize, void, FirstFit>>::type;
+    };
+
+    template <typename U>
+    using PoolFor = Pool<PoolSet, typename Route<U>::type>;
+
+    template <typename U>
+    using Pooled = std::integral_constant<bool,
+                                          !std::is_void<
+                                            typename Route<U>::type>::value>;
+
+    template <typename U>
+    static void* allocateFrom(std::true_type /* pooled */)
+    {
+        return PoolFor<U>::allocate();
+    }
+
+    template <typename U>
+    static void* allocateFrom(std::false_type /* pooled */)
+    {
+        return ::operator new(sizeof(U));
+    }
+
+    template <typename U>
+    static void deallocateTo(std::true_type /* pooled */, U* p)
+    {
+        PoolFor<U>::deallocate(p);
+    }
+
+    template <typename U>
+    static void deallocateTo(std::false_type /* pooled */, U* p)
+    {
+        ::operator delete(p);
+    }
+
+public:
+    /// Allocate a block for one U
+    template <typename U>
+    static U* allocate()
+    {
+        return static_cast<U*>(allocateFrom<U>(Pooled<U>()));
+    }
+
+    /// Return a block from allocate<U>()
+    template <typename U>
+    static void deallocate(U* p)
+    {
+        deallocateTo(Pooled<U>(), p);
+    }
+};
+
+/// Standard allocator that allocates single objects from Pools
+template <typename T, typename Pools>
+class PoolAllocator
+{
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = RebindArgs<U, Pools, PoolAllocator>;
+    };
+
+    PoolAllocator() noexcept { }
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U, Pools>&) noexcept { }
+
+    T* allocate(std::size_t n)
+    {
+        return n == 1 ? Pools::template allocate<T>()
+                      : static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept
+    {
+        n == 1 ? Pools::deallocate(p) : ::operator delete(p);
+    }
+};
+
+template <typename T, typename U, typename Pools>
+bool operator==(const PoolAllocator<T, Pools>&, const PoolAllocator<U, Pools>&)
+{
+    return true;
+}
+
+template <typename T, typename U, typename Pools>
+bool operator!=(const PoolAllocator<T, Pools>&, const PoolAllocator<U, Pools>&)
+{
+    return false;
+}
+
+// Demo
+
+// Size classes for the pools. Nodes are routed to the smallest that fits.
+template <std::size_t N>
+using Slot = typename std::aligned_storage<N, alignof(void*)>::type;
+
+using Pools = PoolSet<std::tuple<Slot<64>, Slot<16>, Slot<32>,
+                                 Slot<24>, Slot<48>>>;
+
+template <typename T>
+using Allocator = PoolAllocator<T, Pools>;
+
+static_assert(std::is_same<std::allocator_traits<Allocator<int>>
+                             ::rebind_alloc<double>,
+                           Allocator<double>>(), "");
+
+// Insert and erase elements in node-based containers using allocator A
+template <template <class> class A>
+void Churn(int rounds, int elements)
+{
+    for (int r = 0; r < rounds; ++r)
+    {
+        std::list<int, A<int>> list;
+        std::map<int, int, std::less<int>, A<std::pair<const int, int>>> map;
+        std::unordered_map<int, int, std::hash<int>, std::equal_to<int>,
+                           A<std::pair<const int, int>>> hash;
+        for (int i = 0; i < elements; ++i)
+        {
+            list.push_back(i);
+            map.emplace(i, i);
+            hash.emplace(i, i);
+        }
+        for (int i = 0; i < elements; i += 2)
+        {
+            list.pop_front();
+            map.erase(i);
+            hash.erase(i);
+        }
+    }
+}
+
+using Clock = std::chrono::steady_clock;
+
+// Run Churn on several threads at once and return the elapsed milliseconds
+template <template <class> class A>
+double Milliseconds(int threads, int rounds, int elements)
+{
+    const Clock::time_point start = Clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t)
+    {
+        workers.emplace_back(Churn<A>, rounds, elements);
+    }
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+    const std::chrono::duration<double, std::milli> elapsed
+      = Clock::now() - start;
+    return elapsed.count();
+}
+
+int main()
+{
+    const int threads = 4;
+    const int rounds = 50;
+    const int elements = 10000;
+
+    const double standard = Milliseconds<std::allocator>(threads, rounds,
+                                                         elements);
+    const double pooled = Milliseconds<Allocator>(threads, rounds, elements);
+
+    std::cout << threads << " threads: std::allocator " << standard << " ms, "
+              << "PoolAllocator " << pooled << " ms\n";
+}
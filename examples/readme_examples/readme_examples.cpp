@@ -1,5 +1,6 @@
 #include "rebind.h"
 
+#include <memory>
 #include <tuple>
 #include <type_traits>
 #include <type_traits>
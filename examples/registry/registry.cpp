@@ -0,0 +1,228 @@
+#include "rebind.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+
+using namespace rebind;
+
+// A registry of factories, keyed on each type's compile-time name. Given a list
+// of types that each provide "static constexpr const char* name()", Registry
+// sorts them by name at compile time and lays out a constant table of
+// (name, constructor) pairs. There is nothing to run at startup - the table is
+// constant-initialised - and lookups are an allocation-free binary search.
+
+// Compare two C-strings in a constant expression
+constexpr bool NameLess(const char* a, const char* b)
+{
+    return *a == *b ? (*a != '\0' && NameLess(a + 1, b + 1))
+                    : static_cast<unsigned char>(*a)
+                        < static_cast<unsigned char>(*b);
+}
+
+// Order types by their names
+template <typename T1, typename T2>
+using ByName = std::integral_constant<bool, NameLess(T1::name(), T2::name())>;
+
+// Helper for rejecting duplicate names, given a list that is sorted by name
+template <typename... Types>
+struct NamesDistinct : std::true_type { };
+
+template <typename T1, typename T2, typename... Types>
+struct NamesDistinct<T1, T2, Types...>
+  : std::integral_constant<bool, ByName<T1, T2>::value
+                                 && NamesDistinct<T2, Types...>::value> { };
+
+template <typename Base, typename T>
+std::unique_ptr<Base> Construct()
+{
+    return std::unique_ptr<Base>(new T());
+}
+
+// Implementation of Registry, below, for a list of types already sorted by name
+template <typename Base>
+struct RegistryImpl
+{
+    template <typename... Types>
+    struct Impl
+    {
+        static_assert(sizeof...(Types) > 0, "Registry must not be empty");
+        static_assert(NamesDistinct<Types...>(), "Duplicate name in Registry");
+
+        using Factory = std::unique_ptr<Base> (*)();
+
+        struct Entry
+        {
+            const char* name;
+            Factory create;
+        };
+
+        static constexpr Entry entries[] = {
+            {Types::name(), &Construct<Base, Types>}...
+        };
+
+        static constexpr std::size_t size() { return sizeof...(Types); }
+
+        // The name of the Nth entry, in sorted order
+        static constexpr const char* name(std::size_t n)
+        {
+            return entries[n].name;
+        }
+
+        // Find the factory for the given name, or nullptr if there isn't one
+        static Factory find(const char* name)
+        {
+            const Entry* end = entries + size();
+            const Entry* it = std::lower_bound(
+                entries, end, name, [](const Entry& e, const char* n) {
+                    return std::strcmp(e.name, n) < 0;
+                });
+            return it != end && std::strcmp(it->name, name) == 0 ? it->create
+                                                                  : nullptr;
+        }
+
+        // Construct the type with the given name, or return nullptr if there
+        // isn't one
+        static std::unique_ptr<Base> create(const char* name)
+        {
+            const Factory factory = find(name);
+            return factory ? factory() : nullptr;
+        }
+    };
+};
+
+// Storage for RegistryImpl
+template <typename Base>
+template <typename... Types>
+constexpr typename RegistryImpl<Base>::template Impl<Types...>::Entry
+  RegistryImpl<Base>::Impl<Types...>::entries[];
+
+// Registry of the types in Arguments, each of which derives from Base
+template <typename Arguments, typename Base>
+using Registry = Rebind<Sort<Arguments, ByName>,
+                        RegistryImpl<Base>::template Impl>;
+
+// Demo
+
+struct Shape
+{
+    virtual ~Shape() { }
+    virtual int sides() const = 0;
+};
+
+template <int Sides>
+struct Polygon : Shape
+{
+    int sides() const override { return Sides; }
+};
+
+struct Triangle : Polygon<3>
+{ static constexpr const char* name() { return "triangle"; } };
+
+struct Square : Polygon<4>
+{ static constexpr const char* name() { return "square"; } };
+
+struct Pentagon : Polygon<5>
+{ static constexpr const char* name() { return "pentagon"; } };
+
+struct Hexagon : Polygon<6>
+{ static constexpr const char* name() { return "hexagon"; } };
+
+struct Heptagon : Polygon<7>
+{ static constexpr const char* name() { return "heptagon"; } };
+
+struct Octagon : Polygon<8>
+{ static constexpr const char* name() { return "octagon"; } };
+
+struct Nonagon : Polygon<9>
+{ static constexpr const char* name() { return "nonagon"; } };
+
+struct Decagon : Polygon<10>
+{ static constexpr const char* name() { return "decagon"; } };
+
+using Shapes = std::tuple<Triangle, Square, Pentagon, Hexagon,
+                          Heptagon, Octagon, Nonagon, Decagon>;
+
+using ShapeRegistry = Registry<Shapes, Shape>;
+
+// The table is built and sorted entirely at compile time
+static_assert(ShapeRegistry::size() == 8, "");
+static_assert(NameLess(ShapeRegistry::name(0), "e"), "");
+static_assert(!NameLess(ShapeRegistry::name(7), "t"), "");
+
+// The equivalent of a static-registration pattern: each type adds its
+// factory to a map during dynamic initialisation.
+using ShapeMap = std::unordered_map<std::string, std::unique_ptr<Shape> (*)()>;
+
+template <typename... Types>
+struct RegisterAll
+{
+    static void into(ShapeMap& map)
+    {
+        using Expand = int[];
+        (void)Expand{(map.emplace(Types::name(), &Construct<Shape, Types>),
+                      0)...};
+    }
+};
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+double NanosecondsPer(int iterations, F f)
+{
+    const Clock::time_point start = Clock::now();
+    for (int i = 0; i < iterations; ++i)
+    {
+        f(i);
+    }
+    const std::chrono::duration<double, std::nano> elapsed
+      = Clock::now() - start;
+    return elapsed.count() / iterations;
+}
+
+int main()
+{
+    const char* const names[] = {"triangle", "square", "pentagon", "hexagon",
+                                 "heptagon", "octagon", "nonagon", "decagon",
+                                 "circle"};
+    const int numNames = sizeof(names) / sizeof(names[0]);
+    const int iterations = 1000000;
+
+    // Startup cost: the registry has none, the map must be populated
+    std::size_t sink = 0;
+    const double mapStartup = NanosecondsPer(10000, [&](int) {
+        ShapeMap map;
+        Rebind<Shapes, RegisterAll>::into(map);
+        sink += map.size();
+    });
+
+    ShapeMap map;
+    Rebind<Shapes, RegisterAll>::into(map);
+
+    // Lookup latency, including one miss. The map is keyed on std::string,
+    // so the const char* names must be converted on each lookup, just as
+    // they would be in a real caller.
+    const double mapLookup = NanosecondsPer(iterations, [&](int i) {
+        const ShapeMap::const_iterator it = map.find(names[i % numNames]);
+        sink += it != map.end();
+    });
+
+    const double registryLookup = NanosecondsPer(iterations, [&](int i) {
+        sink += ShapeRegistry::find(names[i % numNames]) != nullptr;
+    });
+
+    std::cout << "startup:  unordered_map " << mapStartup << " ns, "
+              << "Registry 0 ns (constant-initialised)\n"
+              << "lookup:   unordered_map " << mapLookup << " ns, "
+              << "Registry " << registryLookup << " ns\n";
+
+    const std::unique_ptr<Shape> shape = ShapeRegistry::create("hexagon");
+    std::cout << "hexagon has " << shape->sides() << " sides\n";
+
+    return sink == 0;
+}
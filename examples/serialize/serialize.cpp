@@ -0,0 +1,419 @@
+#include "rebind.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <tuple>
+#include <vector>
+
+using namespace rebind;
+
+// Binary serialisation generated from a list of field types. WireFormat lays
+// out a record in memory following the usual alignment rules, and on the wire
+// with the fields packed back to back. Both sets of offsets are computed at
+// compile time with Accumulate, and runs of fields that are adjacent in memory
+// are merged into a single memcpy. When the two layouts are identical a
+// buffer can be viewed as a record in place, without copying at all.
+//
+// Fields must be trivially copyable and are written in native byte order.
+
+constexpr std::size_t AlignUp(std::size_t n, std::size_t alignment)
+{
+    return (n + alignment - 1) / alignment * alignment;
+}
+
+constexpr std::size_t Max(std::size_t a, std::size_t b)
+{
+    return a < b ? b : a;
+}
+
+// Where a field of type T lives in memory and on the wire
+template <typename T, std::size_t Mem, std::size_t Wire>
+struct Placement
+{
+    using type = T;
+    static constexpr std::size_t mem = Mem;
+    static constexpr std::size_t wire = Wire;
+};
+
+// A run of bytes that is contiguous both in memory and on the wire
+template <std::size_t Mem, std::size_t Wire, std::size_t Size>
+struct Chunk
+{
+    static constexpr std::size_t mem = Mem;
+    static constexpr std::size_t wire = Wire;
+    static constexpr std::size_t size = Size;
+};
+
+// Running state for the layout computation, below
+template <std::size_t Mem,
+          std::size_t Wire,
+          std::size_t Alignment,
+          typename Placements>
+struct LayoutState
+{
+    static constexpr std::size_t mem = Mem;
+    static constexpr std::size_t wire = Wire;
+    static constexpr std::size_t alignment = Alignment;
+    using placements = Placements;
+};
+
+// Accumulate operation to place one more field after those already in State
+template <typename State, typename T>
+using PlaceField
+  = LayoutState<AlignUp(State::mem, alignof(T)) + sizeof(T),
+                State::wire + sizeof(T),
+                Max(State::alignment, alignof(T)),
+                Append<typename State::placements,
+                       Placement<T,
+                                 AlignUp(State::mem, alignof(T)),
+                                 State::wire>>>;
+
+// Accumulate operation to either extend the last chunk with the next field, if
+// there is no padding between them, or start a new chunk
+template <typename Chunks, typename P>
+struct MergeFieldImpl
+{
+private:
+    using Previous = Last<Chunks>;
+
+public:
+    using type = typename std::conditional<
+        Previous::mem + Previous::size == P::mem,
+        Append<DropLast<Chunks>,
+               Chunk<Previous::mem,
+                     Previous::wire,
+                     Previous::size + sizeof(typename P::type)>>,
+        Append<Chunks, Chunk<P::mem, P::wire, sizeof(typename P::type)>>
+      >::type;
+};
+
+template <typename Chunks, typename P>
+using MergeField = typename MergeFieldImpl<Chunks, P>::type;
+
+// True iff a placed field sits at different offsets in memory and on the wire
+template <typename P>
+using Misplaced = std::integral_constant<bool, P::mem != P::wire>;
+
+template <typename T>
+using NotTriviallyCopyable
+  = std::integral_constant<bool, !std::is_trivially_copyable<T>::value>;
+
+// Copy each chunk between a record and a wire buffer
+template <typename... Chunks>
+struct CopyChunks
+{
+    static void toWire(unsigned char* out, const unsigned char* record)
+    {
+        using Expand = int[];
+        (void)Expand{0, (std::memcpy(out + Chunks::wire,
+                                     record + Chunks::mem,
+                                     Chunks::size), 0)...};
+    }
+
+    static void fromWire(unsigned char* record, const unsigned char* in)
+    {
+        using Expand = int[];
+        (void)Expand{0, (std::memcpy(record + Chunks::mem,
+                                     in + Chunks::wire,
+                                     Chunks::size), 0)...};
+    }
+};
+
+template <typename Fields>
+class WireFormat
+{
+    static_assert(!Any<Fields, NotTriviallyCopyable>(),
+                  "WireFormat fields must be trivially copyable");
+
+    using Layout = Accumulate<Fields,
+                              LayoutState<0, 0, 1, std::tuple<>>,
+                              PlaceField>;
+
+    using Placements = typename Layout::placements;
+
+    // Start from an empty chunk at offset zero, which the first field extends
+    using Chunks = Accumulate<Placements,
+                              std::tuple<Chunk<0, 0, 0>>,
+                              MergeField>;
+
+    using Copy = Rebind<Chunks, CopyChunks>;
+
+public:
+    /// Number of bytes a record occupies on the wire
+    static constexpr std::size_t wireSize = Layout::wire;
+
+    /// Number of memcpys needed to (de)serialise a record
+    static constexpr std::size_t copies = Size<Chunks>::value;
+
+    /// True iff records have the same layout in memory and on the wire
+    static constexpr bool zeroCopy
+      = !Any<Placements, Misplaced>::value
+        && AlignUp(Layout::mem, Layout::alignment) == Layout::wire;
+
+    /// Storage for one record, with each field at its in-memory offset
+    class Record
+    {
+    public:
+        Record() : storage_() { }
+
+        template <std::size_t N>
+        Nth<N, Fields>& get()
+        {
+            return *reinterpret_cast<Nth<N, Fields>*>(
+                bytes() + Nth<N, Placements>::mem);
+        }
+
+        template <std::size_t N>
+        const Nth<N, Fields>& get() const
+        {
+            return *reinterpret_cast<const Nth<N, Fields>*>(
+                bytes() + Nth<N, Placements>::mem);
+        }
+
+    private:
+        friend class WireFormat;
+
+        unsigned char* bytes()
+        {
+            return reinterpret_cast<unsigned char*>(&storage_);
+        }
+
+        const unsigned char* bytes() const
+        {
+            return reinterpret_cast<const unsigned char*>(&storage_);
+        }
+
+        typename std::aligned_storage<AlignUp(Layout::mem, Layout::alignment),
+                                      Layout::alignment>::type storage_;
+    };
+
+    /// Write record to out, returning the number of bytes written, or zero if
+    /// outSize is too small
+    static std::size_t serialize(const Record& record,
+                                 void* out,
+                                 std::size_t outSize)
+    {
+        if (outSize < wireSize)
+        {
+            return 0;
+        }
+        Copy::toWire(static_cast<unsigned char*>(out), record.bytes());
+        return wireSize;
+    }
+
+    /// Read record from in, returning the number of bytes read, or zero if
+    /// inSize is too small
+    static std::size_t deserialize(const void* in,
+                                   std::size_t inSize,
+                                   Record& record)
+    {
+        if (inSize < wireSize)
+        {
+            return 0;
+        }
+        Copy::fromWire(record.bytes(), static_cast<const unsigned char*>(in));
+        return wireSize;
+    }
+
+    /// View the record at the start of in without copying it. Only available
+    /// when the layouts match; returns nullptr if inSize is too small or in is
+    /// not suitably aligned.
+    static const Record* view(const void* in, std::size_t inSize)
+    {
+        static_assert(zeroCopy,
+                      "view() requires matching memory and wire layouts");
+        const bool aligned
+          = reinterpret_cast<std::uintptr_t>(in) % alignof(Record) == 0;
+        return inSize >= wireSize && aligned
+                 ? static_cast<const Record*>(in)
+                 : nullptr;
+    }
+};
+
+// Demo
+
+// Padding after id, so two copies are needed
+using Order = std::tuple<std::uint32_t,   // id
+                         double,          // price
+                         std::uint32_t,   // quantity
+                         std::uint16_t,   // venue
+                         char,            // side
+                         char>;           // flags
+
+using OrderFormat = WireFormat<Order>;
+
+static_assert(OrderFormat::wireSize == 20, "");
+static_assert(OrderFormat::copies == 2, "");
+static_assert(!OrderFormat::zeroCopy, "");
+
+// No padding at all, so one copy is needed and buffers can be viewed in place
+using Quote = std::tuple<std::uint64_t,   // id
+                         double,          // bid
+                         double,          // ask
+                         std::uint32_t,   // size
+                         std::uint16_t,   // venue
+                         char,            // side
+                         char>;           // flags
+
+using QuoteFormat = WireFormat<Quote>;
+
+static_assert(QuoteFormat::wireSize == 32, "");
+static_assert(QuoteFormat::copies == 1, "");
+static_assert(QuoteFormat::zeroCopy, "");
+
+// The hand-written alternative: one bounds-checked write per field
+struct Writer
+{
+    unsigned char* pos;
+    unsigned char* end;
+
+    template <typename T>
+    bool put(const T& value)
+    {
+        if (static_cast<std::size_t>(end - pos) < sizeof(T))
+        {
+            return false;
+        }
+        std::memcpy(pos, &value, sizeof(T));
+        pos += sizeof(T);
+        return true;
+    }
+};
+
+struct Reader
+{
+    const unsigned char* pos;
+    const unsigned char* end;
+
+    template <typename T>
+    bool get(T& value)
+    {
+        if (static_cast<std::size_t>(end - pos) < sizeof(T))
+        {
+            return false;
+        }
+        std::memcpy(&value, pos, sizeof(T));
+        pos += sizeof(T);
+        return true;
+    }
+};
+
+struct NaiveOrder
+{
+    std::uint32_t id;
+    double price;
+    std::uint32_t quantity;
+    std::uint16_t venue;
+    char side;
+    char flags;
+
+    bool serialize(Writer& w) const
+    {
+        return w.put(id) && w.put(price) && w.put(quantity) && w.put(venue)
+            && w.put(side) && w.put(flags);
+    }
+
+    bool deserialize(Reader& r)
+    {
+        return r.get(id) && r.get(price) && r.get(quantity) && r.get(venue)
+            && r.get(side) && r.get(flags);
+    }
+};
+
+using Clock = std::chrono::steady_clock;
+
+// Run f over the buffer repeatedly and return the throughput in GB/s
+template <typename F>
+double GigabytesPerSecond(std::size_t bytes, int repeats, F f)
+{
+    const Clock::time_point start = Clock::now();
+    for (int i = 0; i < repeats; ++i)
+    {
+        f();
+    }
+    const std::chrono::duration<double, std::nano> elapsed
+      = Clock::now() - start;
+    return static_cast<double>(bytes) * repeats / elapsed.count();
+}
+
+int main()
+{
+    const std::size_t count = 100000;
+    const int repeats = 50;
+    const std::size_t bytes = count * OrderFormat::wireSize;
+
+    std::vector<OrderFormat::Record> orders(count);
+    std::vector<NaiveOrder> naiveOrders(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        OrderFormat::Record& o = orders[i];
+        o.get<0>() = static_cast<std::uint32_t>(i);
+        o.get<1>() = 100.0 + static_cast<double>(i % 1000) / 8;
+        o.get<2>() = static_cast<std::uint32_t>(i % 500);
+        o.get<3>() = static_cast<std::uint16_t>(i % 16);
+        o.get<4>() = i % 2 ? 'B' : 'S';
+        o.get<5>() = 0;
+
+        const NaiveOrder naive = {o.get<0>(), o.get<1>(), o.get<2>(),
+                                  o.get<3>(), o.get<4>(), o.get<5>()};
+        naiveOrders[i] = naive;
+    }
+
+    std::vector<unsigned char> buffer(bytes);
+    unsigned char* const begin = buffer.data();
+    unsigned char* const end = begin + bytes;
+
+    const double generatedOut = GigabytesPerSecond(bytes, repeats, [&]() {
+        unsigned char* pos = begin;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            pos += OrderFormat::serialize(orders[i], pos, end - pos);
+        }
+    });
+
+    const double generatedIn = GigabytesPerSecond(bytes, repeats, [&]() {
+        const unsigned char* pos = begin;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            pos += OrderFormat::deserialize(pos, end - pos, orders[i]);
+        }
+    });
+
+    const double naiveOut = GigabytesPerSecond(bytes, repeats, [&]() {
+        Writer w = {begin, end};
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            naiveOrders[i].serialize(w);
+        }
+    });
+
+    const double naiveIn = GigabytesPerSecond(bytes, repeats, [&]() {
+        Reader r = {begin, end};
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            naiveOrders[i].deserialize(r);
+        }
+    });
+
+    std::cout << "serialize:   generated " << generatedOut << " GB/s, "
+              << "per-field " << naiveOut << " GB/s\n"
+              << "deserialize: generated " << generatedIn << " GB/s, "
+              << "per-field " << naiveIn << " GB/s\n";
+
+    // Round trip a quote, then view the wire bytes in place
+    QuoteFormat::Record quote;
+    quote.get<0>() = 42;
+    quote.get<1>() = 99.5;
+    quote.get<2>() = 100.25;
+
+    std::vector<std::uint64_t> quoteBuffer(QuoteFormat::wireSize / 8);
+    QuoteFormat::serialize(quote, quoteBuffer.data(), QuoteFormat::wireSize);
+    const QuoteFormat::Record* view
+      = QuoteFormat::view(quoteBuffer.data(), QuoteFormat::wireSize);
+    std::cout << "quote " << view->get<0>() << ": " << view->get<1>()
+              << " / " << view->get<2>() << '\n';
+
+    return orders[count - 1].get<0>() != count - 1;
+}
@@ -125,6 +125,13 @@ using Any = Accumulate<TransformEach<Arguments, Pred>,
                        std::false_type,
                        LogicalOr>;
 
+/// Stable sort of the sequence, where Less<A, B> is an integral constant that
+/// is true iff A should be ordered before B.
+/// E.g. Sort<std::tuple<char[3], char[1], char[2]>, SmallerThan>
+///        -> std::tuple<char[1], char[2], char[3]>
+template <typename Arguments, template <class, class> class Less>
+using Sort = typename detail::SortImpl<Arguments, Less>::type;
+
 } // namespace rebind
 
 #include "rebind_detail.h"
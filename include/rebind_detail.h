@@ -157,6 +157,67 @@ struct SizeImpl
     enum { value = sizeof...(Args) };
 };
 
+// Insert Arg into the already-sorted SortedArguments, before the first element
+// that is not Less than it
+template <template <class...> class Template,
+          typename Arg,
+          template <class, class> class Less>
+struct InsertSortedImpl<Template<>, Arg, Less>
+{
+    using type = Template<Arg>;
+};
+
+template <template <class...> class Template,
+          typename Head,
+          typename... Tail,
+          typename Arg,
+          template <class, class> class Less>
+struct InsertSortedImpl<Template<Head, Tail...>,
+                        Arg,
+                        Less,
+                        typename std::enable_if<!Less<Head, Arg>::value>::type>
+{
+    using type = Template<Arg, Head, Tail...>;
+};
+
+template <template <class...> class Template,
+          typename Head,
+          typename... Tail,
+          typename Arg,
+          template <class, class> class Less>
+struct InsertSortedImpl<Template<Head, Tail...>,
+                        Arg,
+                        Less,
+                        typename std::enable_if<Less<Head, Arg>::value>::type>
+{
+    using type = Join<Template<Head>,
+                      typename InsertSortedImpl<Template<Tail...>,
+                                                Arg,
+                                                Less>::type>;
+};
+
+template <typename Arguments, template <class, class> class Less>
+struct SortImpl
+{
+private:
+    // Sort everything after the first element
+    using SortedTail = Sort<DropFirst<Arguments>, Less>;
+
+public:
+    // Insert the first element ahead of any equal elements, keeping the sort
+    // stable
+    using type = typename InsertSortedImpl<SortedTail,
+                                           First<Arguments>,
+                                           Less>::type;
+};
+
+template <template <class...> class Template,
+          template <class, class> class Less>
+struct SortImpl<Template<>, Less>
+{
+    using type = Template<>;
+};
+
 } } // namespace rebind::detail
 
 #endif
@@ -53,6 +53,15 @@ struct NthImpl;
 template <typename... Args>
 struct SizeImpl;
 
+template <typename SortedArguments,
+          typename Arg,
+          template <class, class> class Less,
+          typename=void>
+struct InsertSortedImpl;
+
+template <typename Arguments, template <class, class> class Less>
+struct SortImpl;
+
 } } // namespace rebind::detail
 
 #endif
@@ -228,6 +228,33 @@ static_assert(!Any<TestArgs<>, IsIntegral>(), "");
 static_assert(Any<TestArgs<int, double>, IsIntegral>(), "");
 static_assert(!Any<TestArgs<float, double>, IsIntegral>(), "");
 
+////////////////////////////////////////////////////////////////////////////////
+// Test Sort
+////////////////////////////////////////////////////////////////////////////////
+
+template <int N>
+using Int = std::integral_constant<int, N>;
+
+template <typename IC1, typename IC2>
+using LessThan = std::integral_constant<bool, (IC1::value < IC2::value)>;
+
+template <typename T1, typename T2>
+using SmallerThan = std::integral_constant<bool, (sizeof(T1) < sizeof(T2))>;
+
+static_assert(std::is_same<Sort<TestArgs<>, LessThan>,
+                           TestArgs<>>(), "");
+static_assert(std::is_same<Sort<TestArgs<Int<1>>, LessThan>,
+                           TestArgs<Int<1>>>(), "");
+static_assert(std::is_same<Sort<TestArgs<Int<2>, Int<0>, Int<1>>, LessThan>,
+                           TestArgs<Int<0>, Int<1>, Int<2>>>(), "");
+static_assert(std::is_same<Sort<std::tuple<Int<3>, Int<1>, Int<3>>, LessThan>,
+                           std::tuple<Int<1>, Int<3>, Int<3>>>(), "");
+
+// Equal elements keep their original order
+static_assert(std::is_same<Sort<TestArgs<char[2], signed char, char[1]>,
+                                SmallerThan>,
+                           TestArgs<signed char, char[1], char[2]>>(), "");
+
 ////////////////////////////////////////////////////////////////////////////////
 // Main function
 ////////////////////////////////////////////////////////////////////////////////